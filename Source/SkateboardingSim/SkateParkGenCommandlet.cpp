@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SkateParkGenCommandlet.h"
+#include "SkateParkGenerator.h"
+#include "SkateParkLayout.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+
+USkateParkGenCommandlet::USkateParkGenCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USkateParkGenCommandlet::Main(const FString& Params)
+{
+	FSkateParkLayoutParams LayoutParams;
+	FParse::Value(*Params, TEXT("Seed="), LayoutParams.Seed);
+	FParse::Value(*Params, TEXT("Size="), LayoutParams.ParkSize);
+	FParse::Value(*Params, TEXT("Chunks="), LayoutParams.ChunksPerSide);
+	FParse::Value(*Params, TEXT("MinSpacing="), LayoutParams.MinSpacing);
+
+	int32 BaselineCount = 40;
+	FParse::Value(*Params, TEXT("Baseline="), BaselineCount);
+
+	int32 Iterations = 3;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(Iterations, 1);
+
+	FString MultipliersString = TEXT("10,100,1000");
+	FParse::Value(*Params, TEXT("Multipliers="), MultipliersString, false);
+
+	TArray<FString> MultiplierStrings;
+	MultipliersString.ParseIntoArray(MultiplierStrings, TEXT(","));
+
+	const bool bSpawn = FParse::Param(*Params, TEXT("Spawn"));
+
+	int32 Result = 0;
+
+	for (const FString& MultiplierString : MultiplierStrings)
+	{
+		const int32 Multiplier = FCString::Atoi(*MultiplierString);
+		if (Multiplier <= 0)
+		{
+			UE_LOG(LogSkatePark, Warning, TEXT("Ignoring invalid multiplier '%s'"), *MultiplierString);
+			continue;
+		}
+
+		LayoutParams.PieceCount = BaselineCount * Multiplier;
+
+		// Keep the best time, the first run also pays for waking up the worker threads
+		double BestTime = TNumericLimits<double>::Max();
+		FSkateParkLayout Layout;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Layout = FSkateParkLayout::Build(LayoutParams);
+			BestTime = FMath::Min(BestTime, FPlatformTime::Seconds() - StartTime);
+		}
+
+		const double SingleStartTime = FPlatformTime::Seconds();
+		const FSkateParkLayout SingleThreadedLayout = FSkateParkLayout::Build(LayoutParams, false);
+		const double SingleThreadedTime = FPlatformTime::Seconds() - SingleStartTime;
+
+		const uint32 Checksum = Layout.GetChecksum();
+		const bool bDeterministic = Checksum == SingleThreadedLayout.GetChecksum();
+		if (!bDeterministic)
+		{
+			Result = 1;
+		}
+
+		UE_LOG(LogSkatePark, Display,
+			TEXT("%5dx: %8d pieces (%d piles, %d stacks, %d scaffolds, %d ramps), parallel %.2f ms, single %.2f ms, checksum %08x%s"),
+			Multiplier, Layout.Pieces.Num(),
+			Layout.PieceCounts[(int32)ESkateParkPiece::LumberPile],
+			Layout.PieceCounts[(int32)ESkateParkPiece::LumberStack],
+			Layout.PieceCounts[(int32)ESkateParkPiece::Scaffolding],
+			Layout.PieceCounts[(int32)ESkateParkPiece::Ramp],
+			BestTime * 1000.0, SingleThreadedTime * 1000.0, Checksum,
+			bDeterministic ? TEXT("") : TEXT(" NOT DETERMINISTIC"));
+
+		if (bSpawn)
+		{
+			UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.bDeferConstruction = true;
+			ASkateParkGenerator* Generator = World->SpawnActor<ASkateParkGenerator>(SpawnParams);
+			Generator->LayoutParams = LayoutParams;
+			Generator->bGenerateOnBeginPlay = false;
+			Generator->FinishSpawning(FTransform::Identity);
+
+			const double SpawnStartTime = FPlatformTime::Seconds();
+			Generator->Generate();
+			const double SpawnTime = FPlatformTime::Seconds() - SpawnStartTime;
+
+			UE_LOG(LogSkatePark, Display, TEXT("%5dx: generated and instanced in %.2f ms"), Multiplier, SpawnTime * 1000.0);
+
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+	}
+
+	return Result;
+}
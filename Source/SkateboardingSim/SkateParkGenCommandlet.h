@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SkateParkGenCommandlet.generated.h"
+
+/**
+* @brief Generates procedural skate parks and reports how long they take.
+*
+* Used by perf tests to build parks at several multiples of a baseline obstacle count.
+* Every layout is built twice, once in parallel and once on a single thread, and the
+* checksums are compared to make sure the result only depends on the seed.
+*
+* Usage:
+*   UnrealEditor-Cmd SkateboardingSim.uproject -run=SkateParkGen
+*     [-Seed=1337] [-Size=100000] [-Chunks=16] [-MinSpacing=400] [-Baseline=40]
+*     [-Multipliers=10,100,1000] [-Iterations=3] [-Spawn]
+*
+* -Spawn also emits the instanced geometry into a transient world and times that.
+*/
+UCLASS()
+class USkateParkGenCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	/* Default Constructor */
+	USkateParkGenCommandlet();
+
+	/**
+	* Runs the commandlet.
+	*
+	* @param Params The command line passed to the commandlet.
+	* @return 0 on success, 1 if any layout was not deterministic.
+	*/
+	virtual int32 Main(const FString& Params) override;
+};
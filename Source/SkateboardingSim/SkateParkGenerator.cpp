@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SkateParkGenerator.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/ConstructorHelpers.h"
+
+DEFINE_LOG_CATEGORY(LogSkatePark);
+
+//////////////////////////////////////////////////////////////////////////
+// ASkateParkGenerator
+
+ASkateParkGenerator::ASkateParkGenerator()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	// Same tag the hand-placed obstacles use, so the character's jump trace picks the park up
+	Tags.Add(TEXT("Obstacle"));
+
+	// Create one instanced component per piece type
+	static const TCHAR* ComponentNames[] =
+	{
+		TEXT("LumberPileInstances"),
+		TEXT("LumberStackInstances"),
+		TEXT("ScaffoldingInstances"),
+		TEXT("RampInstances"),
+	};
+	static_assert(UE_ARRAY_COUNT(ComponentNames) == (int32)ESkateParkPiece::Count, "Missing piece component name");
+
+	for (const TCHAR* ComponentName : ComponentNames)
+	{
+		UHierarchicalInstancedStaticMeshComponent* PieceComponent =
+			CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(ComponentName);
+		PieceComponent->SetupAttachment(RootComponent);
+		PieceComponents.Add(PieceComponent);
+	}
+
+	// Default meshes. The scaffolding meshes the obstacle Blueprints use are not in Content,
+	// so ScaffoldingMesh has no default and must be set on the actor.
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> LumberPileMeshFinder(
+		TEXT("/Game/Obstacles/SM_LumberPile_A02_N1"));
+	if (LumberPileMeshFinder.Succeeded())
+	{
+		LumberPileMesh = LumberPileMeshFinder.Object;
+	}
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> LumberStackMeshFinder(
+		TEXT("/Game/Obstacles/SM_LumberStack_C01_N1"));
+	if (LumberStackMeshFinder.Succeeded())
+	{
+		LumberStackMesh = LumberStackMeshFinder.Object;
+	}
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> RampMeshFinder(
+		TEXT("/Game/LevelPrototyping/Meshes/SM_Ramp"));
+	if (RampMeshFinder.Succeeded())
+	{
+		RampMesh = RampMeshFinder.Object;
+	}
+}
+
+void ASkateParkGenerator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bGenerateOnBeginPlay)
+	{
+		Generate();
+	}
+}
+
+void ASkateParkGenerator::Generate()
+{
+	Clear();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Layout = FSkateParkLayout::Build(LayoutParams);
+
+	const double LayoutTime = FPlatformTime::Seconds();
+
+	// Bucket the transforms by type so each component gets a single batched add
+	TArray<FTransform> Transforms[(int32)ESkateParkPiece::Count];
+	for (int32 TypeIndex = 0; TypeIndex < (int32)ESkateParkPiece::Count; ++TypeIndex)
+	{
+		Transforms[TypeIndex].Reserve(Layout.PieceCounts[TypeIndex]);
+	}
+	for (const FSkateParkPiece& Piece : Layout.Pieces)
+	{
+		Transforms[(int32)Piece.Type].Add(Piece.Transform);
+	}
+
+	for (int32 TypeIndex = 0; TypeIndex < (int32)ESkateParkPiece::Count; ++TypeIndex)
+	{
+		UStaticMesh* Mesh = GetMeshForPiece((ESkateParkPiece)TypeIndex);
+		if (Mesh == nullptr)
+		{
+			if (Transforms[TypeIndex].Num() > 0)
+			{
+				UE_LOG(LogSkatePark, Warning, TEXT("'%s' has no mesh for %s, skipping %d pieces"),
+					*GetNameSafe(this), *UEnum::GetValueAsString((ESkateParkPiece)TypeIndex),
+					Transforms[TypeIndex].Num());
+			}
+			continue;
+		}
+
+		UHierarchicalInstancedStaticMeshComponent* PieceComponent = PieceComponents[TypeIndex];
+		PieceComponent->SetStaticMesh(Mesh);
+		PieceComponent->AddInstances(Transforms[TypeIndex], false);
+	}
+
+	const double EndTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogSkatePark, Log, TEXT("Generated park '%s': seed %d, %d pieces, layout %.2f ms, instancing %.2f ms"),
+		*GetNameSafe(this), LayoutParams.Seed, Layout.Pieces.Num(),
+		(LayoutTime - StartTime) * 1000.0, (EndTime - LayoutTime) * 1000.0);
+}
+
+void ASkateParkGenerator::Clear()
+{
+	for (UHierarchicalInstancedStaticMeshComponent* PieceComponent : PieceComponents)
+	{
+		if (PieceComponent)
+		{
+			PieceComponent->ClearInstances();
+		}
+	}
+
+	Layout = FSkateParkLayout();
+}
+
+int32 ASkateParkGenerator::GetPointsForComponent(const UPrimitiveComponent* Component) const
+{
+	const int32 TypeIndex = PieceComponents.IndexOfByKey(Component);
+	if (TypeIndex == INDEX_NONE || (ESkateParkPiece)TypeIndex == ESkateParkPiece::Ramp)
+	{
+		return 0;
+	}
+
+	return ObstaclePoints;
+}
+
+UStaticMesh* ASkateParkGenerator::GetMeshForPiece(ESkateParkPiece Type) const
+{
+	switch (Type)
+	{
+	case ESkateParkPiece::LumberPile:
+		return LumberPileMesh;
+	case ESkateParkPiece::LumberStack:
+		return LumberStackMesh;
+	case ESkateParkPiece::Scaffolding:
+		return ScaffoldingMesh;
+	case ESkateParkPiece::Ramp:
+		return RampMesh;
+	default:
+		return nullptr;
+	}
+}
@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SkateParkLayout.h"
+#include "SkateParkGenerator.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSkatePark, Log, All);
+
+/**
+* @brief Builds a procedural skate park from a seed.
+*
+* The layout is generated in parallel chunks by FSkateParkLayout and then emitted as
+* one instanced mesh component per piece type, so even very large parks only cost a
+* handful of draw calls. The actor is tagged as an obstacle and reports the points
+* each of its components is worth, which the character uses when scoring jumps.
+*/
+UCLASS()
+class ASkateParkGenerator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/* Default Constructor */
+	ASkateParkGenerator();
+
+	/** Clears any previous park and generates a new one from LayoutParams. */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Park")
+	void Generate();
+
+	/** Removes every generated instance. */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Park")
+	void Clear();
+
+	/**
+	* Gets the number of points awarded for jumping over the given component.
+	*
+	* @param Component The component that was jumped over.
+	* @return The points for that component, or 0 if it is not a scoring obstacle.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Points")
+	int32 GetPointsForComponent(const UPrimitiveComponent* Component) const;
+
+	/** Returns the layout from the last call to Generate. */
+	const FSkateParkLayout& GetLayout() const { return Layout; }
+
+protected:
+	/** Called when the game starts or when spawned. */
+	virtual void BeginPlay() override;
+
+public:
+	/** Settings used to lay out the park. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Park")
+	FSkateParkLayoutParams LayoutParams;
+
+	/** Whether to generate the park when play begins. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Park")
+	bool bGenerateOnBeginPlay = true;
+
+	/** Points awarded for jumping over a generated obstacle. Ramps never score. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Points")
+	int32 ObstaclePoints = 100;
+
+	/** Mesh used for lumber piles. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Meshes")
+	UStaticMesh* LumberPileMesh = nullptr;
+
+	/** Mesh used for lumber stacks. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Meshes")
+	UStaticMesh* LumberStackMesh = nullptr;
+
+	/**
+	* Mesh used for scaffolding. Has no default, so it must be set on the actor or a subclass;
+	* until then scaffolding pieces are laid out but skipped with a warning and never score.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Meshes")
+	UStaticMesh* ScaffoldingMesh = nullptr;
+
+	/** Mesh used for ramps. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Meshes")
+	UStaticMesh* RampMesh = nullptr;
+
+private:
+	/** Returns the mesh set for the given piece type. */
+	UStaticMesh* GetMeshForPiece(ESkateParkPiece Type) const;
+
+	/** One instanced component per piece type, indexed by ESkateParkPiece. */
+	UPROPERTY(VisibleAnywhere, Category = "Park")
+	TArray<UHierarchicalInstancedStaticMeshComponent*> PieceComponents;
+
+	/** The layout from the last call to Generate. */
+	FSkateParkLayout Layout;
+};
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SkateParkLayout.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+
+FSkateParkLayout FSkateParkLayout::Build(const FSkateParkLayoutParams& Params, bool bParallel)
+{
+	FSkateParkLayout Layout;
+
+	const int32 ChunksPerSide = FMath::Clamp(Params.ChunksPerSide, 1, 256);
+	const int32 NumChunks = ChunksPerSide * ChunksPerSide;
+	const int32 TotalPieces = FMath::Max(Params.PieceCount, 0);
+	const float ChunkSize = Params.ParkSize / ChunksPerSide;
+	const float HalfPark = Params.ParkSize * 0.5f;
+
+	// Work out every chunk's slice of the output up front so the chunks never share state
+	TArray<int32> ChunkOffsets;
+	ChunkOffsets.SetNumUninitialized(NumChunks + 1);
+	ChunkOffsets[0] = 0;
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		const int32 ChunkPieces = TotalPieces / NumChunks + (ChunkIndex < TotalPieces % NumChunks ? 1 : 0);
+		ChunkOffsets[ChunkIndex + 1] = ChunkOffsets[ChunkIndex] + ChunkPieces;
+	}
+
+	Layout.Pieces.SetNum(TotalPieces);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 First = ChunkOffsets[ChunkIndex];
+		const int32 ChunkPieces = ChunkOffsets[ChunkIndex + 1] - First;
+		if (ChunkPieces == 0)
+		{
+			return;
+		}
+
+		FRandomStream Stream((int32)HashCombine(GetTypeHash(Params.Seed), GetTypeHash(ChunkIndex)));
+
+		const FVector2D ChunkOrigin(
+			(ChunkIndex % ChunksPerSide) * ChunkSize - HalfPark,
+			(ChunkIndex / ChunksPerSide) * ChunkSize - HalfPark);
+
+		// One cell per piece to spread the pieces out. Each piece stays at least MinSpacing / 2 from
+		// its cell edges, which also holds across chunk edges, so neighbouring centres are at least
+		// MinSpacing apart whenever the cells are that large.
+		const int32 CellsPerSide = FMath::CeilToInt(FMath::Sqrt((float)ChunkPieces));
+		const float CellSize = ChunkSize / CellsPerSide;
+		const float MaxOffset = FMath::Min(CellSize * Params.Jitter, FMath::Max((CellSize - Params.MinSpacing) * 0.5f, 0.0f));
+
+		for (int32 PieceIndex = 0; PieceIndex < ChunkPieces; ++PieceIndex)
+		{
+			FSkateParkPiece& Piece = Layout.Pieces[First + PieceIndex];
+
+			if (Stream.FRand() < Params.RampFraction)
+			{
+				Piece.Type = ESkateParkPiece::Ramp;
+			}
+			else
+			{
+				Piece.Type = (ESkateParkPiece)Stream.RandRange(0, (int32)ESkateParkPiece::Ramp - 1);
+			}
+
+			const FVector Location(
+				ChunkOrigin.X + ((PieceIndex % CellsPerSide) + 0.5f) * CellSize + Stream.FRandRange(-MaxOffset, MaxOffset),
+				ChunkOrigin.Y + ((PieceIndex / CellsPerSide) + 0.5f) * CellSize + Stream.FRandRange(-MaxOffset, MaxOffset),
+				0.0f);
+
+			// Ramps snap to right angles so runs between them line up
+			const float Yaw = Piece.Type == ESkateParkPiece::Ramp
+				? Stream.RandRange(0, 3) * 90.0f
+				: Stream.FRandRange(0.0f, 360.0f);
+
+			Piece.Transform = FTransform(FRotator(0.0f, Yaw, 0.0f), Location);
+		}
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	for (const FSkateParkPiece& Piece : Layout.Pieces)
+	{
+		Layout.PieceCounts[(int32)Piece.Type]++;
+	}
+
+	return Layout;
+}
+
+uint32 FSkateParkLayout::GetChecksum() const
+{
+	uint32 Crc = 0;
+	for (const FSkateParkPiece& Piece : Pieces)
+	{
+		const FVector Location = Piece.Transform.GetLocation();
+		const FQuat Rotation = Piece.Transform.GetRotation();
+
+		Crc = FCrc::MemCrc32(&Piece.Type, sizeof(Piece.Type), Crc);
+		Crc = FCrc::MemCrc32(&Location, sizeof(Location), Crc);
+		Crc = FCrc::MemCrc32(&Rotation, sizeof(Rotation), Crc);
+	}
+	return Crc;
+}
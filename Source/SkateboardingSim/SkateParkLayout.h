@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SkateParkLayout.generated.h"
+
+/** The kinds of pieces the park generator can place. */
+UENUM(BlueprintType)
+enum class ESkateParkPiece : uint8
+{
+	LumberPile,
+	LumberStack,
+	Scaffolding,
+	Ramp,
+
+	Count UMETA(Hidden)
+};
+
+/** A single placed piece of a generated park. */
+USTRUCT(BlueprintType)
+struct FSkateParkPiece
+{
+	GENERATED_BODY()
+
+	/** Which mesh this piece uses. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Park")
+	ESkateParkPiece Type = ESkateParkPiece::LumberPile;
+
+	/** Transform of the piece relative to the generator. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Park")
+	FTransform Transform;
+};
+
+/**
+* @brief Settings used to lay out a procedural skate park.
+*
+* The same settings always produce the same layout, regardless of how many
+* worker threads take part in building it.
+*/
+USTRUCT(BlueprintType)
+struct FSkateParkLayoutParams
+{
+	GENERATED_BODY()
+
+	/** Seed for the whole park. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Park")
+	int32 Seed = 1337;
+
+	/** Length of one side of the square park, in cm. Default is 1 km. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Park", meta = (ClampMin = "1000.0"))
+	float ParkSize = 100000.0f;
+
+	/** Total number of pieces (obstacles and ramps) to place. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Park", meta = (ClampMin = "0"))
+	int32 PieceCount = 4000;
+
+	/** Number of chunks along each side. Chunks are built in parallel. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Park", meta = (ClampMin = "1", ClampMax = "256"))
+	int32 ChunksPerSide = 16;
+
+	/** Fraction of the pieces that are ramps instead of obstacles. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Park", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float RampFraction = 0.2f;
+
+	/** How far a piece may stray from the centre of its cell, as a fraction of the cell size. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Park", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+	float Jitter = 0.3f;
+
+	/**
+	* Minimum distance between the centres of neighbouring pieces, in cm. Jitter is reduced to keep
+	* it, so it should cover the largest piece footprint. It can only be kept while the cells are at
+	* least this large; denser parks are packed on a plain grid.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Park", meta = (ClampMin = "0.0"))
+	float MinSpacing = 400.0f;
+};
+
+/**
+* @brief A deterministic, chunked skate park layout.
+*
+* The park is split into a grid of chunks. Every chunk owns a fixed slice of the
+* output array and its own random stream derived from the seed and the chunk
+* index, so the chunks can be built in any order on any number of threads and
+* still produce identical results.
+*/
+struct FSkateParkLayout
+{
+	/** All pieces, ordered by chunk. */
+	TArray<FSkateParkPiece> Pieces;
+
+	/** Number of pieces of each type. */
+	int32 PieceCounts[(int32)ESkateParkPiece::Count] = {};
+
+	/**
+	* Builds a layout from the given settings.
+	*
+	* @param Params The layout settings.
+	* @param bParallel Whether to build the chunks on the task graph.
+	* @return The generated layout.
+	*/
+	static FSkateParkLayout Build(const FSkateParkLayoutParams& Params, bool bParallel = true);
+
+	/**
+	* Computes a checksum over every piece, used to verify determinism.
+	*
+	* @return CRC of the piece types and transforms.
+	*/
+	uint32 GetChecksum() const;
+};
@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SkateSurface.h"
+#include "Components/PrimitiveComponent.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Materials/MaterialInterface.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("SkateSurface"), STATGROUP_SkateSurface, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Material Lookups/s"), STAT_SkateSurfaceLookups, STATGROUP_SkateSurface);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Material Lookups Avoided/s"), STAT_SkateSurfaceLookupsAvoided, STATGROUP_SkateSurface);
+
+static TAutoConsoleVariable<bool> CVarSkateSurfaceShowLookups(
+	TEXT("skate.Surface.ShowLookups"),
+	false,
+	TEXT("Show the physical material lookups made and avoided per second on screen. Works without stats."));
+
+namespace SkateSurface
+{
+	/** Start of the current window. Only touched on the game thread. */
+	static double WindowStartTime = 0.0;
+
+	/** Lookups made in the current window. */
+	static uint32 WindowLookups = 0;
+
+	/** Lookups avoided in the current window. */
+	static uint32 WindowLookupsAvoided = 0;
+
+	/** Ticker that publishes the window, registered on the first lookup. */
+	static FTSTicker::FDelegateHandle PublishTickerHandle;
+
+	/**
+	* Publishes the rates for the window that just ended and starts a new one.
+	*
+	* Runs from a ticker so the rates drop to zero while nobody is on the ground, and divides
+	* by the real window length in case the ticker fired late.
+	*/
+	static bool PublishWindow(float DeltaTime)
+	{
+		const double Now = FPlatformTime::Seconds();
+		const double WindowSeconds = FMath::Max(Now - WindowStartTime, UE_DOUBLE_SMALL_NUMBER);
+
+		const uint32 LookupsPerSecond = FMath::RoundToInt32(WindowLookups / WindowSeconds);
+		const uint32 LookupsAvoidedPerSecond = FMath::RoundToInt32(WindowLookupsAvoided / WindowSeconds);
+
+		SET_DWORD_STAT(STAT_SkateSurfaceLookups, LookupsPerSecond);
+		SET_DWORD_STAT(STAT_SkateSurfaceLookupsAvoided, LookupsAvoidedPerSecond);
+
+		if (CVarSkateSurfaceShowLookups.GetValueOnGameThread() && GEngine)
+		{
+			GEngine->AddOnScreenDebugMessage((uint64)(UPTRINT)&PublishTickerHandle, 1.5f, FColor::Cyan,
+				FString::Printf(TEXT("Surface material lookups: %u/s, avoided: %u/s"), LookupsPerSecond, LookupsAvoidedPerSecond));
+		}
+
+		WindowStartTime = Now;
+		WindowLookups = 0;
+		WindowLookupsAvoided = 0;
+		return true;
+	}
+}
+
+EPhysicalSurface FSkateSurfaceCache::Resolve(const UPrimitiveComponent* FloorComponent)
+{
+	if (FloorComponent == nullptr)
+	{
+		return SurfaceType_Default;
+	}
+
+	const TObjectKey<UPrimitiveComponent> Key(FloorComponent);
+	if (Key == LastComponent)
+	{
+		CountLookup(true);
+		return LastSurface;
+	}
+
+	if (SurfaceByComponent.Contains(Key))
+	{
+		CountLookup(true);
+	}
+	else
+	{
+		// First time on this component, resolve its physical material once
+		const UPhysicalMaterial* PhysicalMaterial = FloorComponent->BodyInstance.GetSimplePhysicalMaterial();
+
+		// Complex collision and meshes without a BodySetup material take it from the surface material
+		if (PhysicalMaterial == nullptr || PhysicalMaterial == GEngine->DefaultPhysMaterial)
+		{
+			if (const UMaterialInterface* Material = FloorComponent->GetMaterial(0))
+			{
+				PhysicalMaterial = Material->GetPhysicalMaterial();
+			}
+		}
+		SurfaceByComponent.Add(Key, UPhysicalMaterial::DetermineSurfaceType(PhysicalMaterial));
+		CountLookup(false);
+	}
+
+	LastComponent = Key;
+	LastSurface = SurfaceByComponent.FindChecked(Key);
+	return LastSurface;
+}
+
+void FSkateSurfaceCache::Reset()
+{
+	SurfaceByComponent.Reset();
+	LastComponent = TObjectKey<UPrimitiveComponent>();
+	LastSurface = SurfaceType_Default;
+}
+
+void FSkateSurfaceCache::CountLookup(bool bAvoided)
+{
+	using namespace SkateSurface;
+
+	if (!PublishTickerHandle.IsValid())
+	{
+		WindowStartTime = FPlatformTime::Seconds();
+		PublishTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateStatic(&PublishWindow), 1.0f);
+	}
+
+	if (bAvoided)
+	{
+		WindowLookupsAvoided++;
+	}
+	else
+	{
+		WindowLookups++;
+	}
+}
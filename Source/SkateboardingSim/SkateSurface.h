@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "UObject/ObjectKey.h"
+#include "SkateSurface.generated.h"
+
+class UPrimitiveComponent;
+class USoundBase;
+
+/** How the board rolls over one kind of surface. */
+USTRUCT(BlueprintType)
+struct FSkateSurfaceProperties
+{
+	GENERATED_BODY()
+
+	/** Ground friction while rolling on this surface. Lower values slide more. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface", meta = (ClampMin = "0.0"))
+	float GroundFriction = 0.2f;
+
+	/** Deceleration from the wheels when not pushing or slowing down, in cm/s^2. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface", meta = (ClampMin = "0.0"))
+	float RollingResistance = 150.0f;
+
+	/** Rolling sound for this surface. Falls back to the character's RollingSound when unset. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface")
+	USoundBase* RollingSound = nullptr;
+
+	/** Scales the rolling volume on this surface. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface", meta = (ClampMin = "0.0"))
+	float RollingVolume = 1.0f;
+};
+
+/**
+* @brief Remembers the physical surface of every floor component a skater has rolled on.
+*
+* The floor component comes from the movement component's floor result, so no extra traces
+* are needed. The physical material is only looked up the first time a component is seen;
+* afterwards the cached surface type is reused. The lookup uses the component's override or
+* the mesh's BodySetup physical material, falling back to the physical material of the
+* component's first material slot, so one surface is used per component. Lookups made and
+* avoided per second are shown by "stat SkateSurface" and, without stats, by
+* skate.Surface.ShowLookups.
+*/
+class FSkateSurfaceCache
+{
+public:
+	/**
+	* Gets the physical surface of a floor component.
+	*
+	* @param FloorComponent The component the skater is standing on.
+	* @return The surface type, or SurfaceType_Default if the component has no physical material.
+	*/
+	EPhysicalSurface Resolve(const UPrimitiveComponent* FloorComponent);
+
+	/** Forgets every cached component. */
+	void Reset();
+
+private:
+	/** Counts a resolve towards the per second stats. */
+	static void CountLookup(bool bAvoided);
+
+	/** Surface type of every floor component seen so far. */
+	TMap<TObjectKey<UPrimitiveComponent>, EPhysicalSurface> SurfaceByComponent;
+
+	/** The last component resolved, checked before the map since the floor rarely changes. */
+	TObjectKey<UPrimitiveComponent> LastComponent;
+
+	/** Surface type of LastComponent. */
+	EPhysicalSurface LastSurface = SurfaceType_Default;
+};
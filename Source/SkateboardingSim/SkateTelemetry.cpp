@@ -0,0 +1,422 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SkateTelemetry.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY(LogSkateTelemetry);
+
+namespace SkateTelemetry
+{
+	const TCHAR* FileExtension = TEXT(".sktl");
+
+	/** Marks the start of a file. */
+	static constexpr uint32 FileMagic = 0x4C544B53; // 'SKTL'
+
+	/** Bumped whenever the layout of the file changes. */
+	static constexpr uint32 FileVersion = 1;
+
+	/** Marks the start of a block of samples. */
+	static constexpr uint32 BlockTag = 0x4B4C4253; // 'SBLK'
+
+	/** Marks the start of the session summary. */
+	static constexpr uint32 SummaryTag = 0x4D555353; // 'SSUM'
+
+	/** Marks a complete file, stored after the summary offset. */
+	static constexpr uint32 TrailerMagic = 0x444E4553; // 'SEND'
+
+	/** Size of the trailer: the summary offset followed by TrailerMagic. */
+	static constexpr int64 TrailerSize = sizeof(int64) + sizeof(uint32);
+
+	/** Compression used for every column. */
+	static const FName CompressionFormat = NAME_Zlib;
+
+	/**
+	* Reads one column written by FSkateTelemetryWriter::WriteBlock.
+	*
+	* @param Ar The archive to read from.
+	* @param Dest Where to put the uncompressed column.
+	* @param ExpectedSize Size of the uncompressed column in bytes.
+	* @param Scratch Buffer for the compressed bytes.
+	* @return True if the column was read.
+	*/
+	static bool ReadColumn(FArchive& Ar, void* Dest, int32 ExpectedSize, TArray<uint8>& Scratch)
+	{
+		int32 UncompressedSize = 0;
+		int32 CompressedSize = 0;
+		Ar << UncompressedSize << CompressedSize;
+
+		if (Ar.IsError() || UncompressedSize != ExpectedSize || CompressedSize <= 0
+			|| CompressedSize > Ar.TotalSize() - Ar.Tell())
+		{
+			return false;
+		}
+
+		// Columns that did not compress are stored as is
+		if (CompressedSize == UncompressedSize)
+		{
+			Ar.Serialize(Dest, UncompressedSize);
+			return !Ar.IsError();
+		}
+
+		Scratch.SetNumUninitialized(CompressedSize, false);
+		Ar.Serialize(Scratch.GetData(), CompressedSize);
+
+		return !Ar.IsError()
+			&& FCompression::UncompressMemory(CompressionFormat, Dest, UncompressedSize, Scratch.GetData(), CompressedSize);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FSkateTelemetryBlock
+
+void FSkateTelemetryBlock::Add(const FSkateTelemetrySample& Sample)
+{
+	check(!IsFull());
+
+	Time[NumSamples] = Sample.Time;
+	Speed[NumSamples] = Sample.Speed;
+	FrameTime[NumSamples] = Sample.FrameTime;
+	ObstaclesCleared[NumSamples] = Sample.ObstaclesCleared;
+	Airborne[NumSamples] = Sample.bAirborne ? 1 : 0;
+	SpeedMode[NumSamples] = (uint8)Sample.SpeedMode;
+	++NumSamples;
+}
+
+FSkateTelemetrySample FSkateTelemetryBlock::Get(int32 Index) const
+{
+	check(Index >= 0 && Index < NumSamples);
+
+	FSkateTelemetrySample Sample;
+	Sample.Time = Time[Index];
+	Sample.Speed = Speed[Index];
+	Sample.FrameTime = FrameTime[Index];
+	Sample.ObstaclesCleared = ObstaclesCleared[Index];
+	Sample.bAirborne = Airborne[Index] != 0;
+	Sample.SpeedMode = (ESkateTelemetrySpeedMode)SpeedMode[Index];
+	return Sample;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FSkateTelemetrySummary
+
+void FSkateTelemetrySummary::AddSample(const FSkateTelemetrySample& Sample)
+{
+	// Use the real time since the previous sample, the component takes at most one sample
+	// per frame so samples are further apart than 1 / SampleRate when the frame rate is low
+	const float SampleInterval = FMath::Max(Sample.Time - Duration, 0.0f);
+
+	++NumSamples;
+	Duration = Sample.Time;
+	MaxSpeed = FMath::Max(MaxSpeed, Sample.Speed);
+	SpeedSum += Sample.Speed;
+	ObstaclesCleared = FMath::Max(ObstaclesCleared, Sample.ObstaclesCleared);
+	FrameTimeSum += Sample.FrameTime;
+	MaxFrameTime = FMath::Max(MaxFrameTime, Sample.FrameTime);
+
+	if (Sample.bAirborne)
+	{
+		AirTime += SampleInterval;
+	}
+	else if (Sample.SpeedMode == ESkateTelemetrySpeedMode::Pushing)
+	{
+		PushTime += SampleInterval;
+	}
+	else if (Sample.SpeedMode == ESkateTelemetrySpeedMode::SlowingDown)
+	{
+		SlowDownTime += SampleInterval;
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FSkateTelemetrySummary& Summary)
+{
+	Ar << Summary.MapName;
+	Ar << Summary.SkaterName;
+	Ar << Summary.SampleRate;
+	Ar << Summary.NumSamples;
+	Ar << Summary.DroppedSamples;
+	Ar << Summary.Duration;
+	Ar << Summary.MaxSpeed;
+	Ar << Summary.SpeedSum;
+	Ar << Summary.AirTime;
+	Ar << Summary.PushTime;
+	Ar << Summary.SlowDownTime;
+	Ar << Summary.ObstaclesCleared;
+	Ar << Summary.FrameTimeSum;
+	Ar << Summary.MaxFrameTime;
+	return Ar;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FSkateTelemetryWriter
+
+FSkateTelemetryWriter::FSkateTelemetryWriter(const FString& InFilename, const FString& MapName,
+	const FString& SkaterName, float SampleRate)
+	: Filename(InFilename)
+{
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+
+	FileWriter = IFileManager::Get().CreateFileWriter(*Filename);
+	if (FileWriter == nullptr)
+	{
+		UE_LOG(LogSkateTelemetry, Error, TEXT("Failed to open telemetry file '%s'"), *Filename);
+		return;
+	}
+
+	uint32 Magic = SkateTelemetry::FileMagic;
+	uint32 Version = SkateTelemetry::FileVersion;
+	FString HeaderMapName = MapName;
+	FString HeaderSkaterName = SkaterName;
+	*FileWriter << Magic << Version << HeaderMapName << HeaderSkaterName << SampleRate;
+
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("SkateTelemetryWriter"), 0, TPri_BelowNormal);
+}
+
+FSkateTelemetryWriter::~FSkateTelemetryWriter()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (WorkEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		WorkEvent = nullptr;
+	}
+
+	delete FileWriter;
+	FileWriter = nullptr;
+}
+
+FSkateTelemetryBlock* FSkateTelemetryWriter::GetWriteBlock()
+{
+	FSkateTelemetryBlock& Block = Blocks[WriteIndex];
+	return Block.bPending.load(std::memory_order_acquire) ? nullptr : &Block;
+}
+
+void FSkateTelemetryWriter::SubmitWriteBlock()
+{
+	FSkateTelemetryBlock& Block = Blocks[WriteIndex];
+	// A pending block belongs to the writer thread, so check that before reading NumSamples
+	if (Block.bPending.load(std::memory_order_acquire) || Block.NumSamples == 0)
+	{
+		return;
+	}
+
+	Block.bPending.store(true, std::memory_order_release);
+	PendingBlocks.Enqueue(WriteIndex);
+	WorkEvent->Trigger();
+
+	WriteIndex = (WriteIndex + 1) % NumBlocks;
+}
+
+void FSkateTelemetryWriter::Finish(FSkateTelemetrySummary& Summary)
+{
+	if (FileWriter == nullptr)
+	{
+		return;
+	}
+
+	SubmitWriteBlock();
+
+	// Let the writer thread drain every pending block before touching the file here
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	int64 SummaryOffset = FileWriter->Tell();
+	uint32 Tag = SkateTelemetry::SummaryTag;
+	uint32 Trailer = SkateTelemetry::TrailerMagic;
+	*FileWriter << Tag << Summary << SummaryOffset << Trailer;
+
+	FileWriter->Close();
+	delete FileWriter;
+	FileWriter = nullptr;
+
+	UE_LOG(LogSkateTelemetry, Log, TEXT("Wrote %d samples (%d dropped) to '%s'"),
+		Summary.NumSamples, Summary.DroppedSamples, *Filename);
+}
+
+uint32 FSkateTelemetryWriter::Run()
+{
+	for (;;)
+	{
+		// Read the flag first so every block submitted before the stop is still drained
+		const bool bStop = bStopping.load(std::memory_order_acquire);
+
+		int32 BlockIndex = INDEX_NONE;
+		while (PendingBlocks.Dequeue(BlockIndex))
+		{
+			FSkateTelemetryBlock& Block = Blocks[BlockIndex];
+			WriteBlock(Block);
+			Block.NumSamples = 0;
+			Block.bPending.store(false, std::memory_order_release);
+		}
+
+		if (bStop)
+		{
+			break;
+		}
+
+		WorkEvent->Wait();
+	}
+
+	return 0;
+}
+
+void FSkateTelemetryWriter::Stop()
+{
+	bStopping.store(true, std::memory_order_release);
+	if (WorkEvent)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+void FSkateTelemetryWriter::WriteBlock(const FSkateTelemetryBlock& Block)
+{
+	FArchive& Ar = *FileWriter;
+
+	uint32 Tag = SkateTelemetry::BlockTag;
+	int32 NumSamples = Block.NumSamples;
+	Ar << Tag << NumSamples;
+
+	auto WriteColumn = [this, &Ar](const void* Data, int32 UncompressedSize)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(SkateTelemetry::CompressionFormat, UncompressedSize);
+		CompressedScratch.SetNumUninitialized(CompressedSize, false);
+
+		const bool bCompressed = FCompression::CompressMemory(SkateTelemetry::CompressionFormat,
+			CompressedScratch.GetData(), CompressedSize, Data, UncompressedSize);
+
+		// Store the column as is when compressing does not help
+		if (!bCompressed || CompressedSize >= UncompressedSize)
+		{
+			Ar << UncompressedSize << UncompressedSize;
+			Ar.Serialize(const_cast<void*>(Data), UncompressedSize);
+		}
+		else
+		{
+			Ar << UncompressedSize << CompressedSize;
+			Ar.Serialize(CompressedScratch.GetData(), CompressedSize);
+		}
+	};
+
+	WriteColumn(Block.Time, NumSamples * sizeof(float));
+	WriteColumn(Block.Speed, NumSamples * sizeof(float));
+	WriteColumn(Block.FrameTime, NumSamples * sizeof(float));
+	WriteColumn(Block.ObstaclesCleared, NumSamples * sizeof(int32));
+	WriteColumn(Block.Airborne, NumSamples * sizeof(uint8));
+	WriteColumn(Block.SpeedMode, NumSamples * sizeof(uint8));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SkateTelemetry
+
+bool SkateTelemetry::ReadSummary(const FString& Filename, FSkateTelemetrySummary& OutSummary)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	FArchive& Ar = *Reader;
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic << Version;
+	if (Ar.IsError() || Magic != FileMagic || Version != FileVersion)
+	{
+		return false;
+	}
+
+	FSkateTelemetrySummary Summary;
+	Ar << Summary.MapName << Summary.SkaterName << Summary.SampleRate;
+	if (Ar.IsError())
+	{
+		return false;
+	}
+
+	const int64 BlocksOffset = Ar.Tell();
+
+	// Fast path: complete files end with the offset of their summary
+	if (Ar.TotalSize() - BlocksOffset >= TrailerSize)
+	{
+		Ar.Seek(Ar.TotalSize() - TrailerSize);
+
+		int64 SummaryOffset = 0;
+		uint32 Trailer = 0;
+		Ar << SummaryOffset << Trailer;
+
+		if (!Ar.IsError() && Trailer == TrailerMagic && SummaryOffset >= BlocksOffset)
+		{
+			Ar.Seek(SummaryOffset);
+
+			uint32 Tag = 0;
+			Ar << Tag;
+			if (Tag == SummaryTag)
+			{
+				Ar << OutSummary;
+				if (!Ar.IsError())
+				{
+					return true;
+				}
+			}
+		}
+
+		Ar.ClearError();
+	}
+
+	// Slow path: rebuild the summary from every block that was fully written
+	UE_LOG(LogSkateTelemetry, Warning, TEXT("'%s' has no summary, rebuilding it from the samples"), *Filename);
+
+	Ar.Seek(BlocksOffset);
+
+	TUniquePtr<FSkateTelemetryBlock> Block = MakeUnique<FSkateTelemetryBlock>();
+	TArray<uint8> Scratch;
+
+	while (!Ar.AtEnd())
+	{
+		uint32 Tag = 0;
+		int32 NumSamples = 0;
+		Ar << Tag << NumSamples;
+		if (Ar.IsError() || Tag != BlockTag || NumSamples <= 0 || NumSamples > FSkateTelemetryBlock::Capacity)
+		{
+			break;
+		}
+
+		const bool bRead =
+			ReadColumn(Ar, Block->Time, NumSamples * sizeof(float), Scratch)
+			&& ReadColumn(Ar, Block->Speed, NumSamples * sizeof(float), Scratch)
+			&& ReadColumn(Ar, Block->FrameTime, NumSamples * sizeof(float), Scratch)
+			&& ReadColumn(Ar, Block->ObstaclesCleared, NumSamples * sizeof(int32), Scratch)
+			&& ReadColumn(Ar, Block->Airborne, NumSamples * sizeof(uint8), Scratch)
+			&& ReadColumn(Ar, Block->SpeedMode, NumSamples * sizeof(uint8), Scratch);
+		if (!bRead)
+		{
+			break;
+		}
+
+		Block->NumSamples = NumSamples;
+		for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+		{
+			Summary.AddSample(Block->Get(SampleIndex));
+		}
+	}
+
+	OutSummary = MoveTemp(Summary);
+	return true;
+}
@@ -0,0 +1,231 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+class FRunnableThread;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSkateTelemetry, Log, All);
+
+/** What the skater was doing with their speed when a sample was taken. */
+enum class ESkateTelemetrySpeedMode : uint8
+{
+	Rolling,
+	Pushing,
+	SlowingDown,
+};
+
+/** A single telemetry sample for one skater. */
+struct FSkateTelemetrySample
+{
+	/** Seconds since the session started. */
+	float Time = 0.0f;
+
+	/** Speed in cm/s. */
+	float Speed = 0.0f;
+
+	/** Average frame time since the previous sample, in ms. */
+	float FrameTime = 0.0f;
+
+	/** Obstacles cleared so far in the session. */
+	int32 ObstaclesCleared = 0;
+
+	/** Whether the skater was in the air. */
+	bool bAirborne = false;
+
+	/** Whether the skater was pushing, slowing down or just rolling. */
+	ESkateTelemetrySpeedMode SpeedMode = ESkateTelemetrySpeedMode::Rolling;
+};
+
+/**
+* @brief A fixed-size block of samples stored column by column.
+*
+* Blocks are allocated once when recording starts and are reused for the whole session,
+* so taking a sample never allocates. Each column is compressed separately on disk.
+*/
+struct FSkateTelemetryBlock
+{
+	/** Number of samples a block can hold. */
+	static constexpr int32 Capacity = 256;
+
+	/** Number of samples currently stored. */
+	int32 NumSamples = 0;
+
+	float Time[Capacity];
+	float Speed[Capacity];
+	float FrameTime[Capacity];
+	int32 ObstaclesCleared[Capacity];
+	uint8 Airborne[Capacity];
+	uint8 SpeedMode[Capacity];
+
+	/** Set while the block is waiting for, or being written by, the writer thread. */
+	std::atomic<bool> bPending { false };
+
+	/** Returns true if no more samples fit. */
+	bool IsFull() const { return NumSamples == Capacity; }
+
+	/** Appends a sample. The block must not be full. */
+	void Add(const FSkateTelemetrySample& Sample);
+
+	/** Reads back the sample at the given index. */
+	FSkateTelemetrySample Get(int32 Index) const;
+};
+
+/** Values that describe a whole session, written at the end of every telemetry file. */
+struct FSkateTelemetrySummary
+{
+	/** Map the session was played on. */
+	FString MapName;
+
+	/** Name of the skater actor. */
+	FString SkaterName;
+
+	/** Samples per second. */
+	float SampleRate = 0.0f;
+
+	/** Number of samples recorded. */
+	int32 NumSamples = 0;
+
+	/** Number of samples dropped because the writer fell behind. */
+	int32 DroppedSamples = 0;
+
+	/** Time of the last sample, in seconds. */
+	float Duration = 0.0f;
+
+	/** Highest speed seen, in cm/s. */
+	float MaxSpeed = 0.0f;
+
+	/** Sum of every sampled speed, used for the average. */
+	double SpeedSum = 0.0;
+
+	/** Seconds spent in the air. */
+	float AirTime = 0.0f;
+
+	/** Seconds spent pushing. */
+	float PushTime = 0.0f;
+
+	/** Seconds spent slowing down. */
+	float SlowDownTime = 0.0f;
+
+	/** Obstacles cleared during the session. */
+	int32 ObstaclesCleared = 0;
+
+	/** Sum of every sampled frame time, used for the average. */
+	double FrameTimeSum = 0.0;
+
+	/** Worst sampled frame time, in ms. */
+	float MaxFrameTime = 0.0f;
+
+	/** Folds a sample into the summary. Samples must be added in time order. */
+	void AddSample(const FSkateTelemetrySample& Sample);
+
+	friend FArchive& operator<<(FArchive& Ar, FSkateTelemetrySummary& Summary);
+};
+
+/**
+* @brief Writes a telemetry file from a background thread.
+*
+* The game thread fills blocks from a small preallocated ring and submits them when full.
+* The writer thread compresses each column of a submitted block, appends it to the file and
+* hands the block back. If every block is still in flight the sample is dropped instead of
+* stalling the game thread.
+*
+* File layout: a header, any number of column-compressed blocks, then the session summary
+* and a trailer pointing at it so the summary can be read without touching the blocks.
+*/
+class FSkateTelemetryWriter : public FRunnable
+{
+public:
+	/** Number of blocks in the ring. */
+	static constexpr int32 NumBlocks = 8;
+
+	/**
+	* Opens the file and starts the writer thread.
+	*
+	* @param InFilename Path of the file to write.
+	* @param MapName Map the session is played on, stored in the header.
+	* @param SkaterName Name of the skater, stored in the header.
+	* @param SampleRate Samples per second, stored in the header.
+	*/
+	FSkateTelemetryWriter(const FString& InFilename, const FString& MapName, const FString& SkaterName, float SampleRate);
+	virtual ~FSkateTelemetryWriter();
+
+	/** Returns true if the file was opened. */
+	bool IsValid() const { return FileWriter != nullptr; }
+
+	/**
+	* Gets the block the game thread should write into.
+	*
+	* @return The current block, or nullptr if every block is waiting to be written.
+	*/
+	FSkateTelemetryBlock* GetWriteBlock();
+
+	/** Hands the current block to the writer thread and moves on to the next one. */
+	void SubmitWriteBlock();
+
+	/**
+	* Submits any partial block, waits for the writer thread and writes the summary.
+	*
+	* @param Summary The session summary to store at the end of the file.
+	*/
+	void Finish(FSkateTelemetrySummary& Summary);
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	/** Compresses and appends one block. Called on the writer thread. */
+	void WriteBlock(const FSkateTelemetryBlock& Block);
+
+	/** The path of the file being written. */
+	FString Filename;
+
+	/** The file being written. */
+	FArchive* FileWriter = nullptr;
+
+	/** The writer thread. */
+	FRunnableThread* Thread = nullptr;
+
+	/** Woken whenever a block is submitted or the writer is stopped. */
+	FEvent* WorkEvent = nullptr;
+
+	/** Set when no more blocks will be submitted. */
+	std::atomic<bool> bStopping { false };
+
+	/** Indices of blocks waiting to be written. */
+	TQueue<int32, EQueueMode::Spsc> PendingBlocks;
+
+	/** Index of the block the game thread is filling. */
+	int32 WriteIndex = 0;
+
+	/** Scratch buffer for compressed columns, only used by the writer thread. */
+	TArray<uint8> CompressedScratch;
+
+	/** The ring of sample blocks. */
+	FSkateTelemetryBlock Blocks[NumBlocks];
+};
+
+/** Reads telemetry files. */
+namespace SkateTelemetry
+{
+	/** File extension used for telemetry files. */
+	extern const TCHAR* FileExtension;
+
+	/**
+	* Reads the summary of a telemetry file.
+	*
+	* Uses the summary at the end of the file when present. Files that were cut short
+	* (for example by a crash) are rebuilt from whichever blocks were fully written.
+	*
+	* @param Filename The file to read.
+	* @param OutSummary The summary that was read.
+	* @return True if the file was a telemetry file.
+	*/
+	bool ReadSummary(const FString& Filename, FSkateTelemetrySummary& OutSummary);
+}
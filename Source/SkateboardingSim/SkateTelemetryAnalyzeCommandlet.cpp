@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SkateTelemetryAnalyzeCommandlet.h"
+#include "SkateTelemetry.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/** Totals for every session played on one map. */
+	struct FSkateMapStats
+	{
+		FString MapName;
+		int32 Sessions = 0;
+		int32 FullSessions = 0;
+		int64 NumSamples = 0;
+		int64 DroppedSamples = 0;
+		double Duration = 0.0;
+		double SpeedSum = 0.0;
+		float MaxSpeed = 0.0f;
+		double AirTime = 0.0;
+		double PushTime = 0.0;
+		double SlowDownTime = 0.0;
+		int64 ObstaclesCleared = 0;
+		double FrameTimeSum = 0.0;
+		float MaxFrameTime = 0.0f;
+
+		double GetAverageFrameTime() const { return NumSamples > 0 ? FrameTimeSum / NumSamples : 0.0; }
+		double GetAverageSpeed() const { return NumSamples > 0 ? SpeedSum / NumSamples : 0.0; }
+		double GetShare(double Time) const { return Duration > 0.0 ? 100.0 * Time / Duration : 0.0; }
+		double GetObstaclesPerMinute() const { return Duration > 0.0 ? 60.0 * ObstaclesCleared / Duration : 0.0; }
+	};
+}
+
+USkateTelemetryAnalyzeCommandlet::USkateTelemetryAnalyzeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USkateTelemetryAnalyzeCommandlet::Main(const FString& Params)
+{
+	FString Directory = FPaths::ProjectSavedDir() / TEXT("Telemetry");
+	FParse::Value(*Params, TEXT("Dir="), Directory);
+
+	int32 TimerSeconds = 120;
+	FParse::Value(*Params, TEXT("TimerSeconds="), TimerSeconds);
+
+	FString CsvFilename;
+	FParse::Value(*Params, TEXT("Csv="), CsvFilename);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FString> Filenames;
+	IFileManager::Get().FindFilesRecursive(Filenames, *Directory,
+		*(FString(TEXT("*")) + SkateTelemetry::FileExtension), true, false);
+
+	// Each file is independent, so read the summaries on every core
+	TArray<FSkateTelemetrySummary> Summaries;
+	Summaries.SetNum(Filenames.Num());
+	TArray<bool> bValid;
+	bValid.SetNumZeroed(Filenames.Num());
+
+	ParallelFor(Filenames.Num(), [&](int32 FileIndex)
+	{
+		bValid[FileIndex] = SkateTelemetry::ReadSummary(Filenames[FileIndex], Summaries[FileIndex]);
+	});
+
+	TMap<FString, FSkateMapStats> StatsByMap;
+	int32 NumRead = 0;
+	for (int32 FileIndex = 0; FileIndex < Filenames.Num(); ++FileIndex)
+	{
+		if (!bValid[FileIndex])
+		{
+			UE_LOG(LogSkateTelemetry, Warning, TEXT("Skipping '%s', not a telemetry file"), *Filenames[FileIndex]);
+			continue;
+		}
+
+		const FSkateTelemetrySummary& Summary = Summaries[FileIndex];
+		FSkateMapStats& Stats = StatsByMap.FindOrAdd(Summary.MapName);
+		Stats.MapName = Summary.MapName;
+		Stats.Sessions++;
+		Stats.FullSessions += Summary.Duration >= TimerSeconds - 1 ? 1 : 0;
+		Stats.NumSamples += Summary.NumSamples;
+		Stats.DroppedSamples += Summary.DroppedSamples;
+		Stats.Duration += Summary.Duration;
+		Stats.SpeedSum += Summary.SpeedSum;
+		Stats.MaxSpeed = FMath::Max(Stats.MaxSpeed, Summary.MaxSpeed);
+		Stats.AirTime += Summary.AirTime;
+		Stats.PushTime += Summary.PushTime;
+		Stats.SlowDownTime += Summary.SlowDownTime;
+		Stats.ObstaclesCleared += Summary.ObstaclesCleared;
+		Stats.FrameTimeSum += Summary.FrameTimeSum;
+		Stats.MaxFrameTime = FMath::Max(Stats.MaxFrameTime, Summary.MaxFrameTime);
+		NumRead++;
+	}
+
+	TArray<FSkateMapStats> SortedStats;
+	StatsByMap.GenerateValueArray(SortedStats);
+
+	// Slowest maps first
+	SortedStats.Sort([](const FSkateMapStats& A, const FSkateMapStats& B)
+	{
+		return A.GetAverageFrameTime() > B.GetAverageFrameTime();
+	});
+
+	UE_LOG(LogSkateTelemetry, Display, TEXT("Read %d of %d telemetry files from '%s' in %.2f s"),
+		NumRead, Filenames.Num(), *Directory, FPlatformTime::Seconds() - StartTime);
+
+	FString Csv = TEXT("Map,Sessions,FullSessions,AvgDuration,ObstaclesPerMinute,AvgSpeed,MaxSpeed,AirPct,PushPct,SlowDownPct,AvgFrameMs,MaxFrameMs,DroppedSamples\n");
+
+	for (const FSkateMapStats& Stats : SortedStats)
+	{
+		const double AverageDuration = Stats.Duration / Stats.Sessions;
+
+		UE_LOG(LogSkateTelemetry, Display,
+			TEXT("%-24s sessions %6d (%5.1f%% full), avg %6.1f s, %5.2f obstacles/min, speed avg %6.1f max %6.1f, air %4.1f%% push %4.1f%% slow %4.1f%%, frame avg %6.2f ms max %7.2f ms, dropped %lld"),
+			*Stats.MapName, Stats.Sessions, 100.0 * Stats.FullSessions / Stats.Sessions, AverageDuration,
+			Stats.GetObstaclesPerMinute(), Stats.GetAverageSpeed(), Stats.MaxSpeed,
+			Stats.GetShare(Stats.AirTime), Stats.GetShare(Stats.PushTime), Stats.GetShare(Stats.SlowDownTime),
+			Stats.GetAverageFrameTime(), Stats.MaxFrameTime, Stats.DroppedSamples);
+
+		Csv += FString::Printf(TEXT("%s,%d,%d,%.2f,%.3f,%.2f,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%lld\n"),
+			*Stats.MapName, Stats.Sessions, Stats.FullSessions, AverageDuration,
+			Stats.GetObstaclesPerMinute(), Stats.GetAverageSpeed(), Stats.MaxSpeed,
+			Stats.GetShare(Stats.AirTime), Stats.GetShare(Stats.PushTime), Stats.GetShare(Stats.SlowDownTime),
+			Stats.GetAverageFrameTime(), Stats.MaxFrameTime, Stats.DroppedSamples);
+	}
+
+	if (!CsvFilename.IsEmpty() && !FFileHelper::SaveStringToFile(Csv, *CsvFilename))
+	{
+		UE_LOG(LogSkateTelemetry, Error, TEXT("Failed to write '%s'"), *CsvFilename);
+	}
+
+	return NumRead > 0 ? 0 : 1;
+}
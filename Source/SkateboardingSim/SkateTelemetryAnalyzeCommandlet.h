@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SkateTelemetryAnalyzeCommandlet.generated.h"
+
+/**
+* @brief Aggregates session telemetry files per map.
+*
+* Reads the summary at the end of every telemetry file in parallel, so thousands of
+* sessions can be processed without decompressing their samples, and prints one row
+* per map sorted by average frame time. The obstacles cleared per minute and the share
+* of sessions that ran the whole timer are meant for balancing the round length.
+*
+* Usage:
+*   UnrealEditor-Cmd SkateboardingSim.uproject -run=SkateTelemetryAnalyze
+*     [-Dir=<Saved/Telemetry>] [-TimerSeconds=120] [-Csv=<output.csv>]
+*/
+UCLASS()
+class USkateTelemetryAnalyzeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	/* Default Constructor */
+	USkateTelemetryAnalyzeCommandlet();
+
+	/**
+	* Runs the commandlet.
+	*
+	* @param Params The command line passed to the commandlet.
+	* @return 0 on success, 1 if no telemetry files could be read.
+	*/
+	virtual int32 Main(const FString& Params) override;
+};
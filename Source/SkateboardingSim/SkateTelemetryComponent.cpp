@@ -0,0 +1,144 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SkateTelemetryComponent.h"
+#include "SkateboardingSimCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<bool> CVarSkateTelemetryEnable(
+	TEXT("skate.Telemetry.Enable"),
+	false,
+	TEXT("Record session telemetry for every skater to Saved/Telemetry. Read when play begins."));
+
+static TAutoConsoleVariable<float> CVarSkateTelemetrySampleRate(
+	TEXT("skate.Telemetry.SampleRate"),
+	30.0f,
+	TEXT("Telemetry samples per second for each skater."));
+
+USkateTelemetryComponent::USkateTelemetryComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	// Sample after movement so speed and airborne state are for this frame
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void USkateTelemetryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!CVarSkateTelemetryEnable.GetValueOnGameThread() || !Cast<ASkateboardingSimCharacter>(GetOwner()))
+	{
+		return;
+	}
+
+	const float SampleRate = FMath::Clamp(CVarSkateTelemetrySampleRate.GetValueOnGameThread(), 1.0f, 240.0f);
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	const FString SkaterName = GetNameSafe(GetOwner());
+
+	// The guid keeps PIE clients, whose pawns share a name, from opening the same file
+	const FString Filename = FPaths::ProjectSavedDir() / TEXT("Telemetry") / FString::Printf(TEXT("%s_%s_%s_%s%s"),
+		*MapName, *SkaterName, *FDateTime::Now().ToString(), *FGuid::NewGuid().ToString(EGuidFormats::Digits),
+		SkateTelemetry::FileExtension);
+
+	Writer = MakeUnique<FSkateTelemetryWriter>(Filename, MapName, SkaterName, SampleRate);
+	if (!Writer->IsValid())
+	{
+		Writer.Reset();
+		return;
+	}
+
+	Summary = FSkateTelemetrySummary();
+	Summary.MapName = MapName;
+	Summary.SkaterName = SkaterName;
+	Summary.SampleRate = SampleRate;
+
+	SampleInterval = 1.0f / SampleRate;
+	SessionTime = 0.0f;
+	TimeSinceSample = 0.0f;
+	FramesSinceSample = 0;
+	FrameTimeSinceSample = 0.0f;
+
+	SetComponentTickEnabled(true);
+}
+
+void USkateTelemetryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Writer)
+	{
+		Writer->Finish(Summary);
+		Writer.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void USkateTelemetryComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	SessionTime += DeltaTime;
+	TimeSinceSample += DeltaTime;
+	++FramesSinceSample;
+
+	// Real frame time, DeltaTime is dilated and clamped to MaxUndilatedFrameTime which hides hitches
+	FrameTimeSinceSample += FApp::GetDeltaTime();
+
+	if (TimeSinceSample >= SampleInterval)
+	{
+		TakeSample();
+
+		// A long hitch still only produces one sample
+		TimeSinceSample = FMath::Fmod(TimeSinceSample, SampleInterval);
+		FramesSinceSample = 0;
+		FrameTimeSinceSample = 0.0f;
+	}
+}
+
+void USkateTelemetryComponent::TakeSample()
+{
+	const ASkateboardingSimCharacter* Character = Cast<ASkateboardingSimCharacter>(GetOwner());
+	if (Writer == nullptr || Character == nullptr)
+	{
+		return;
+	}
+
+	FSkateTelemetryBlock* Block = Writer->GetWriteBlock();
+	if (Block == nullptr)
+	{
+		// The writer is behind, drop the sample rather than wait for it
+		++Summary.DroppedSamples;
+		return;
+	}
+
+	FSkateTelemetrySample Sample;
+	Sample.Time = SessionTime;
+	Sample.Speed = Character->GetVelocity().Size();
+	Sample.FrameTime = FrameTimeSinceSample / FramesSinceSample * 1000.0f;
+	Sample.ObstaclesCleared = Character->GetObstaclesCleared();
+	Sample.bAirborne = Character->GetCharacterMovement()->IsFalling();
+
+	if (Character->IsPushing())
+	{
+		Sample.SpeedMode = ESkateTelemetrySpeedMode::Pushing;
+	}
+	else if (Character->IsSlowingDown())
+	{
+		Sample.SpeedMode = ESkateTelemetrySpeedMode::SlowingDown;
+	}
+
+	Block->Add(Sample);
+	Summary.AddSample(Sample);
+
+	if (Block->IsFull())
+	{
+		Writer->SubmitWriteBlock();
+	}
+}
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "SkateTelemetry.h"
+#include "SkateTelemetryComponent.generated.h"
+
+/**
+* @brief Records session telemetry for the skater that owns it.
+*
+* While skate.Telemetry.Enable is set, the component samples speed, airtime, pushing and
+* slowing down, obstacles cleared and frame time at a fixed rate into preallocated blocks.
+* Full blocks are compressed and written to Saved/Telemetry by a background thread, and the
+* file is closed with a session summary when play ends.
+*/
+UCLASS(ClassGroup = (Skate), meta = (BlueprintSpawnableComponent))
+class USkateTelemetryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/* Default Constructor */
+	USkateTelemetryComponent();
+
+	/**
+	* Called every frame.
+	*
+	* @param DeltaTime The time since the last tick.
+	* @param TickType The kind of tick.
+	* @param ThisTickFunction The tick function that fired.
+	*/
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+		FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	/** Called when the game starts or when spawned. */
+	virtual void BeginPlay() override;
+
+	/** Called when play ends, closes the telemetry file. */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** Takes one sample from the owning character. */
+	void TakeSample();
+
+	/** Writer for the current session, null while not recording. */
+	TUniquePtr<FSkateTelemetryWriter> Writer;
+
+	/** Running summary of the current session. */
+	FSkateTelemetrySummary Summary;
+
+	/** Seconds between samples. */
+	float SampleInterval = 0.0f;
+
+	/** Seconds since the session started. */
+	float SessionTime = 0.0f;
+
+	/** Seconds since the last sample. */
+	float TimeSinceSample = 0.0f;
+
+	/** Frames since the last sample, used to average frame time. */
+	int32 FramesSinceSample = 0;
+
+	/** Sum of the real, undilated frame times since the last sample, in seconds. */
+	float FrameTimeSinceSample = 0.0f;
+};
@@ -15,6 +15,8 @@
 #include "Components/AudioComponent.h"
 #include "Components/BoxComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "SkateParkGenerator.h"
+#include "SkateTelemetryComponent.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
@@ -47,6 +49,25 @@ ASkateboardingSimCharacter::ASkateboardingSimCharacter()
 	
 	// Low friction for sliding effect
 	GetCharacterMovement()->GroundFriction = 0.2f;
+
+	// Surface defaults, matching the physical surface names in DefaultEngine.ini
+	DefaultSurface.GroundFriction = 0.2f;
+	DefaultSurface.RollingResistance = 150.0f;
+	CurrentSurface = DefaultSurface;
+
+	FSkateSurfaceProperties Concrete = DefaultSurface;
+	SurfaceProperties.Add(SurfaceType1, Concrete);
+
+	FSkateSurfaceProperties Wood = DefaultSurface;
+	Wood.GroundFriction = 0.25f;
+	Wood.RollingResistance = 200.0f;
+	Wood.RollingVolume = 0.8f;
+	SurfaceProperties.Add(SurfaceType2, Wood);
+
+	FSkateSurfaceProperties Metal = DefaultSurface;
+	Metal.GroundFriction = 0.15f;
+	Metal.RollingResistance = 100.0f;
+	SurfaceProperties.Add(SurfaceType3, Metal);
 	
 	// Create a camera boom (pulls in towards the player if there is a collision)
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
@@ -71,6 +92,9 @@ ASkateboardingSimCharacter::ASkateboardingSimCharacter()
 	RollingAudioComponent = CreateDefaultSubobject<UAudioComponent>(TEXT("RollingAudioComponent"));
 	RollingAudioComponent->SetupAttachment(RootComponent);
 	RollingAudioComponent->bAutoActivate = false; // Don't start playing automatically
+
+	// Create the telemetry recorder, it stays idle unless telemetry is enabled
+	Telemetry = CreateDefaultSubobject<USkateTelemetryComponent>(TEXT("Telemetry"));
 }
 
 void ASkateboardingSimCharacter::BeginPlay()
@@ -97,23 +121,28 @@ void ASkateboardingSimCharacter::Tick(float DeltaTime)
 	{
 		CheckForObstacle();
 	}
+	else if (GetCharacterMovement()->IsMovingOnGround())
+	{
+		UpdateSurface();
+	}
 
 	float VelocitySize = GetVelocity().Size();
 
 	// Check if the character is moving
 	if (VelocitySize > 0.0f)
 	{
+		USoundBase* SurfaceRollingSound = GetRollingSound();
+
 		// Play the rolling sound if it's not already playing
-		if (!RollingAudioComponent->IsPlaying() && RollingSound)
+		if (!RollingAudioComponent->IsPlaying() && SurfaceRollingSound)
 		{
-			RollingAudioComponent->SetSound(RollingSound);
+			RollingAudioComponent->SetSound(SurfaceRollingSound);
 			RollingAudioComponent->Play();
 		}
 		else if (RollingAudioComponent->IsPlaying())
 		{
-			// Adjust the volume based on the velocity
-			// Adjust 500.0f to match MaxWalkSpeed
-			float NewVolume = FMath::Clamp(VelocitySize / 500.0f, 0.0f, 1.0f);
+			// Adjust the volume based on the velocity relative to normal rolling speed
+			float NewVolume = FMath::Clamp(VelocitySize / DefaultMaxWalkSpeed * CurrentSurface.RollingVolume, 0.0f, 1.0f);
 			RollingAudioComponent->SetVolumeMultiplier(NewVolume);
 		}
 	}
@@ -206,23 +235,68 @@ void ASkateboardingSimCharacter::Look(const FInputActionValue& Value)
 void ASkateboardingSimCharacter::Push()
 {
 	GetCharacterMovement()->MaxWalkSpeed = PushedMaxWalkSpeed;
-	GetCharacterMovement()->BrakingDecelerationWalking = 150.f;
+	GetCharacterMovement()->BrakingDecelerationWalking = CurrentSurface.RollingResistance;
+	bIsPushing = true;
+	bIsSlowingDown = false;
 }
 
 void ASkateboardingSimCharacter::ReturnNormalSpeed()
 {
 	GetCharacterMovement()->MaxWalkSpeed = DefaultMaxWalkSpeed;
+	GetCharacterMovement()->BrakingDecelerationWalking = CurrentSurface.RollingResistance;
+	bIsPushing = false;
+	bIsSlowingDown = false;
 }
 
 void ASkateboardingSimCharacter::SlowDown()
 {
 	GetCharacterMovement()->MaxWalkSpeed = SlowDownMaxWalkSpeed;
-	GetCharacterMovement()->BrakingDecelerationWalking = 1500.f;
+	GetCharacterMovement()->BrakingDecelerationWalking = SlowDownBrakingDeceleration;
+	bIsPushing = false;
+	bIsSlowingDown = true;
 }
 
-void ASkateboardingSimCharacter::AddPoint()
+void ASkateboardingSimCharacter::UpdateSurface()
 {
-	Points += 100;
+	const FFindFloorResult& Floor = GetCharacterMovement()->CurrentFloor;
+	if (!Floor.bBlockingHit)
+	{
+		return;
+	}
+
+	const EPhysicalSurface SurfaceType = SurfaceCache.Resolve(Floor.HitResult.GetComponent());
+	if (SurfaceType == CurrentSurfaceType)
+	{
+		return;
+	}
+
+	const FSkateSurfaceProperties* Properties = SurfaceProperties.Find(SurfaceType);
+	CurrentSurface = Properties ? *Properties : DefaultSurface;
+	CurrentSurfaceType = SurfaceType;
+
+	GetCharacterMovement()->GroundFriction = CurrentSurface.GroundFriction;
+	if (!bIsSlowingDown)
+	{
+		GetCharacterMovement()->BrakingDecelerationWalking = CurrentSurface.RollingResistance;
+	}
+
+	// Swap the rolling sound straight away if it changed
+	USoundBase* SurfaceRollingSound = GetRollingSound();
+	if (RollingAudioComponent->IsPlaying() && RollingAudioComponent->Sound != SurfaceRollingSound)
+	{
+		RollingAudioComponent->SetSound(SurfaceRollingSound);
+	}
+}
+
+USoundBase* ASkateboardingSimCharacter::GetRollingSound() const
+{
+	return CurrentSurface.RollingSound ? CurrentSurface.RollingSound : RollingSound;
+}
+
+void ASkateboardingSimCharacter::AddPoint(int32 PointsToAdd)
+{
+	Points += PointsToAdd;
+	ObstaclesCleared++;
 	UE_LOG(LogTemplateCharacter, Log, TEXT("Points: %d"), Points);
 
 	// Play the point sound at the character's location
@@ -280,9 +354,9 @@ void ASkateboardingSimCharacter::OnLanded()
 	bIsSkating = true;
 
 	// Resume the rolling sound if the character is moving
-	if (GetVelocity().Size() > 0.0f && RollingSound)
+	if (GetVelocity().Size() > 0.0f && GetRollingSound())
 	{
-		RollingAudioComponent->SetSound(RollingSound);
+		RollingAudioComponent->SetSound(GetRollingSound());
 		RollingAudioComponent->Play();
 	}
 }
@@ -300,11 +374,19 @@ void ASkateboardingSimCharacter::CheckForObstacle()
 
 	bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, Params);
 	
+	int32 ObstaclePoints = 0;
 	if (bHit && HitResult.GetActor() && HitResult.GetActor()->ActorHasTag(TEXT("Obstacle")))
+	{
+		// Generated parks hold many pieces in one actor, so ask which piece was hit
+		const ASkateParkGenerator* ParkGenerator = Cast<ASkateParkGenerator>(HitResult.GetActor());
+		ObstaclePoints = ParkGenerator ? ParkGenerator->GetPointsForComponent(HitResult.GetComponent()) : 100;
+	}
+
+	if (ObstaclePoints > 0)
 	{
 		if (!bIsOverObstacle)
 		{
-			AddPoint();
+			AddPoint(ObstaclePoints);
 			bIsOverObstacle = true;
 		}
 	}
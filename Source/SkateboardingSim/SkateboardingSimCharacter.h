@@ -5,12 +5,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Logging/LogMacros.h"
+#include "SkateSurface.h"
 #include "SkateboardingSimCharacter.generated.h"
 
 class USpringArmComponent;
 class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
+class USkateTelemetryComponent;
 struct FInputActionValue;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
@@ -52,6 +54,23 @@ public:
 	{
 		Points = NewPoints;
 	}
+
+	/**
+	* @brief Gets the number of obstacles the character has jumped over.
+	* 
+	* @return The obstacles cleared so far.
+	*/
+	UFUNCTION(BlueprintCallable, Category="Points")
+	int32 GetObstaclesCleared() const
+	{
+		return ObstaclesCleared;
+	}
+
+	/** Returns true while the push action is held. */
+	bool IsPushing() const { return bIsPushing; }
+
+	/** Returns true while the slow down action is held. */
+	bool IsSlowingDown() const { return bIsSlowingDown; }
 	
 public:
 	/* Default Constructor */
@@ -61,6 +80,8 @@ public:
     FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
     /** Returns FollowCamera subobject **/
     FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
+    /** Returns Telemetry subobject **/
+    FORCEINLINE class USkateTelemetryComponent* GetTelemetry() const { return Telemetry; }
 
 protected:
 	/**
@@ -91,6 +112,18 @@ private:
 	/** Handles the slow down action, decreasing speed. */
 	void SlowDown();
 
+	/**
+	* Applies the rolling properties of the surface under the character.
+	* 
+	* The floor component is taken from the movement component's current floor and its
+	* surface type from SurfaceCache, so this does no traces or material lookups once a
+	* component has been seen. Properties are only reapplied when the surface changes.
+	*/
+	void UpdateSurface();
+
+	/** Returns the rolling sound for the current surface. */
+	USoundBase* GetRollingSound() const;
+
 	/**
 	* Checks if the character is currently over an obstacle.
 	* 
@@ -111,8 +144,12 @@ private:
 	*/
 	void FadeOutRollingSound(float DeltaTime);
 
-	/** Adds a point to the character's score. */
-	void AddPoint();
+	/**
+	* Adds points to the character's score.
+	*
+	* @param PointsToAdd The number of points to add.
+	*/
+	void AddPoint(int32 PointsToAdd = 100);
 
 	/** Initiates the jump action if the character is on the ground */
 	void SkateJump();
@@ -139,6 +176,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera = nullptr;
 
+	/** Records session telemetry when skate.Telemetry.Enable is set */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Telemetry, meta = (AllowPrivateAccess = "true"))
+	USkateTelemetryComponent* Telemetry = nullptr;
+
 	/** A box for obstacle detection */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	class UBoxComponent* ObstacleDetector = nullptr;
@@ -215,10 +256,31 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio")
 	USoundBase* JumpSound;
 
+	/** Rolling properties used on surfaces not listed in SurfaceProperties. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface")
+	FSkateSurfaceProperties DefaultSurface;
+
+	/**
+	* Rolling properties for each physical surface type.
+	* Surface types are named in the project's physics settings and assigned through physical materials,
+	* set as the component's override, on the mesh's BodySetup, or on the floor's first material slot.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface")
+	TMap<TEnumAsByte<EPhysicalSurface>, FSkateSurfaceProperties> SurfaceProperties;
+
 private:
 	/** Current points of the character. */
 	int32 Points = 0;
 
+	/** Number of obstacles jumped over. */
+	int32 ObstaclesCleared = 0;
+
+	/** Whether the push action is held. */
+	bool bIsPushing = false;
+
+	/** Whether the slow down action is held. */
+	bool bIsSlowingDown = false;
+
 	/** Default maximum walking speed. */
 	float DefaultMaxWalkSpeed = 500.f;
 
@@ -227,5 +289,17 @@ private:
 
 	/** Maximum walking speed when slowing down. */
 	float SlowDownMaxWalkSpeed = 200.f;
+
+	/** Braking deceleration when slowing down. */
+	float SlowDownBrakingDeceleration = 1500.f;
+
+	/** Caches the surface type of each floor component. */
+	FSkateSurfaceCache SurfaceCache;
+
+	/** Surface type currently applied, SurfaceType_Max until the first floor is found. */
+	EPhysicalSurface CurrentSurfaceType = SurfaceType_Max;
+
+	/** Rolling properties currently applied. */
+	FSkateSurfaceProperties CurrentSurface;
 };
 